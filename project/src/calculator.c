@@ -1,6 +1,7 @@
 #include <pebble.h>
 
 #include "calculator.h"
+#include "history.h"
 
 #define MIN_BILL_DOLLARS 1
 #define MIN_TIP_PERCENT 1
@@ -22,6 +23,10 @@ static CurrencyAmount total;
 static CurrencyAmount total_per_person;
 static int tip_percent;
 static int num_splitting;
+static bool round_total;
+static bool round_total_applied;  // round_total is on and a round total was reachable
+static int round_total_target;     // round total picked with up/down in round-total mode; 0 to follow tip_percent
+static bool is_recorded;           // the check is in the history and hasn't been edited since
 
 
 // Round up if remainder >= 0.5; only use with UNSIGNED integers
@@ -41,10 +46,84 @@ static void currency_amount_set_from_cents(CurrencyAmount *amount, int total_cen
 }
 
 
+// Round to the nearest multiple of step, rounding halves up; only use with UNSIGNED integers
+static int round_to_multiple(int value, int step) {
+  return divide_and_round(value, step) * step;
+}
+
+
+// Round totals are the multiples of the step (100 cents, or 100 per person when splitting) reachable with a tip between
+// MIN_TIP_PERCENT and MAX_TIP_PERCENT of the bill. Returns false if there are none.
+static bool round_total_range(int bill_in_cents, int splitting, int *first_round_total, int *last_round_total) {
+  int step = 100 * splitting;
+  int min_total = bill_in_cents + divide_and_round(bill_in_cents * MIN_TIP_PERCENT, 100);
+  int max_total = bill_in_cents + divide_and_round(bill_in_cents * MAX_TIP_PERCENT, 100);
+
+  *first_round_total = (min_total + step - 1) / step * step;
+  *last_round_total = max_total / step * step;
+  return *first_round_total <= *last_round_total;
+}
+
+
+// Move tip_in_cents to the tip giving preferred_total if that is a reachable round total, and otherwise to the nearest
+// tip that makes the total (or, when splitting, each person's share) a whole number of dollars. The nearest one is the
+// nearest multiple of the step clamped to the reachable range; ties go to the larger tip. Returns false, leaving
+// tip_in_cents unchanged, if no round total is reachable.
+static bool solve_round_tip(int bill_in_cents, int splitting, int preferred_total, int *tip_in_cents) {
+  int step = 100 * splitting;
+  int first_round_total, last_round_total;
+  if(!round_total_range(bill_in_cents, splitting, &first_round_total, &last_round_total)) {
+    return false;
+  }
+
+  int round_total_in_cents;
+  if(preferred_total >= first_round_total && preferred_total <= last_round_total && preferred_total % step == 0) {
+    round_total_in_cents = preferred_total;
+  } else {
+    round_total_in_cents = round_to_multiple(bill_in_cents + *tip_in_cents, step);
+    if(round_total_in_cents < first_round_total) {
+      round_total_in_cents = first_round_total;
+    } else if(round_total_in_cents > last_round_total) {
+      round_total_in_cents = last_round_total;
+    }
+  }
+  *tip_in_cents = round_total_in_cents - bill_in_cents;
+  return true;
+}
+
+
+// Move round_total_target delta round totals away from the applied one, wrapping around the reachable range like the
+// other inputs do.
+static void step_round_total(int delta) {
+  int bill_in_cents = currency_amount_get_in_cents(bill);
+  int step = 100 * num_splitting;
+  int first_round_total, last_round_total;
+  if(!round_total_range(bill_in_cents, num_splitting, &first_round_total, &last_round_total)) {
+    return;
+  }
+
+  int num_round_totals = (last_round_total - first_round_total) / step + 1;
+  int idx = (bill_in_cents + currency_amount_get_in_cents(tip) - first_round_total) / step;
+  idx = ((idx + delta) % num_round_totals + num_round_totals) % num_round_totals;
+  round_total_target = first_round_total + idx * step;
+}
+
+
+int calc_compute_tip_in_cents(int bill_in_cents, int percent, int splitting, bool round) {
+  int tip_in_cents = divide_and_round(bill_in_cents * percent, 100);
+  if(round) {
+    solve_round_tip(bill_in_cents, splitting, 0, &tip_in_cents);
+  }
+  return tip_in_cents;
+}
+
+
 void calc_update_totals(void) {
   int bill_in_cents = currency_amount_get_in_cents(bill);
 
   int tip_in_cents = divide_and_round(bill_in_cents * tip_percent, 100);
+  round_total_applied = round_total &&
+                        solve_round_tip(bill_in_cents, num_splitting, round_total_target, &tip_in_cents);
   currency_amount_set_from_cents(&tip, tip_in_cents);
 
   int total_in_cents = bill_in_cents + tip_in_cents;
@@ -59,10 +138,31 @@ void calc_reset_to_defaults(void) {
   bill = DEFAULT_BILL;
   tip_percent = DEFAULT_TIP_PERCENT;
   num_splitting = DEFAULT_NUM_SPLITTING;
+  round_total = false;
+  round_total_target = 0;
+  is_recorded = false;
   calc_update_totals();
 }
 
 
+void calc_toggle_round_total(void) {
+  round_total = !round_total;
+  round_total_target = 0;
+  is_recorded = false;
+  calc_update_totals();
+}
+
+
+bool calc_is_round_total_on(void) {
+  return round_total;
+}
+
+
+bool calc_is_round_total_applied(void) {
+  return round_total_applied;
+}
+
+
 // ************************************************ persistent storage ************************************************
 
 
@@ -85,6 +185,22 @@ void calc_persist_read(void) {
 }
 
 
+void calc_history_append(void) {
+  // Finishing the same check again (e.g. after backing out of the history) shouldn't push older checks out, but the
+  // same check entered afresh later should get its own entry.
+  if(is_recorded) {
+    return;
+  }
+  history_append((HistoryRecord){
+      .bill_in_cents = currency_amount_get_in_cents(bill),
+      .tip_in_cents = currency_amount_get_in_cents(tip),
+      .num_splitting = num_splitting,
+      .timestamp = time(NULL)
+  });
+  is_recorded = true;
+}
+
+
 // ********************************************* GetTxtCallback callbacks *********************************************
 
 
@@ -104,7 +220,11 @@ char *calc_get_bill_cents_txt(void) {
 
 char *calc_get_tip_percent_txt(void) {
   static char s_buffer[3];
-  snprintf(s_buffer, sizeof(s_buffer), "%d", tip_percent);
+  // Show the percentage actually applied, which differs from tip_percent once the tip is snapped to a round total.
+  int percent = round_total_applied ? divide_and_round(100 * currency_amount_get_in_cents(tip),
+                                                       currency_amount_get_in_cents(bill))
+                                    : tip_percent;
+  snprintf(s_buffer, sizeof(s_buffer), "%d", percent);
   return s_buffer;
 }
 
@@ -133,6 +253,8 @@ char *calc_get_total_per_person_txt(void) {
 // ******************************************* CalcManipCallback callbacks ********************************************
 
 void calc_manip_bill_dollars(int delta) {
+  round_total_target = 0;
+  is_recorded = false;
   if(bill.dollars + delta > MAX_BILL_DOLLARS) {
     bill.dollars = MIN_BILL_DOLLARS;
   } else if(bill.dollars + delta < MIN_BILL_DOLLARS) {
@@ -144,6 +266,8 @@ void calc_manip_bill_dollars(int delta) {
 
 
 void calc_manip_bill_cents(int delta) {
+  round_total_target = 0;
+  is_recorded = false;
   if(bill.cents + delta > 99) {
     bill.cents = 0;
   } else if(bill.cents + delta < 0) {
@@ -155,7 +279,11 @@ void calc_manip_bill_cents(int delta) {
 
 
 void calc_manip_tip_percent(int delta) {
-  if(tip_percent + delta > MAX_TIP_PERCENT) {
+  is_recorded = false;
+  if(round_total_applied) {
+    // Step straight to the next round total instead of through percentages that snap to the same one.
+    step_round_total(delta);
+  } else if(tip_percent + delta > MAX_TIP_PERCENT) {
     tip_percent = MIN_TIP_PERCENT;
   } else if(tip_percent + delta < MIN_TIP_PERCENT) {
     tip_percent = MAX_TIP_PERCENT;
@@ -167,6 +295,8 @@ void calc_manip_tip_percent(int delta) {
 
 
 void calc_manip_num_splitting(int delta) {
+  round_total_target = 0;
+  is_recorded = false;
   if(num_splitting + delta > MAX_NUM_SPLITTING) {
     num_splitting = MIN_NUM_SPLITTING;
   } else if(num_splitting + delta < MIN_NUM_SPLITTING) {
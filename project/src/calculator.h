@@ -10,6 +10,7 @@ typedef struct {
 
 typedef char *(GetTxtCallback)(void);
 typedef void (CalcManipCallback)(int);
+typedef bool (IsMarkedCallback)(void);
 
 void calc_manip_bill_dollars(int);
 void calc_manip_bill_cents(int);
@@ -19,6 +20,19 @@ void calc_manip_num_splitting(int);
 void calc_reset_to_defaults(void);
 void calc_update_totals(void);
 
+//! Toggle snapping the tip so the total (or each person's share, when splitting) is a whole number of dollars.
+void calc_toggle_round_total(void);
+
+//! Whether round-total mode is on.
+bool calc_is_round_total_on(void);
+
+//! Whether round-total mode is on and the tip was actually snapped; false when no round total is within the allowed
+//! tip range.
+bool calc_is_round_total_applied(void);
+
+//! Tip in cents for a bill at the given percent, snapped to a round total (see calc_toggle_round_total) if requested.
+int calc_compute_tip_in_cents(int bill_in_cents, int percent, int splitting, bool round);
+
 char *calc_get_bill_dollars_txt(void);
 char *calc_get_bill_cents_txt(void);
 char *calc_get_tip_percent_txt(void);
@@ -31,4 +45,7 @@ char *calc_get_total_per_person_txt(void);
 void calc_persist_store(void);
 
 //! Read the calculator from persistent storage.
-void calc_persist_read(void);
\ No newline at end of file
+void calc_persist_read(void);
+
+//! Record the current check in the history ring, unless it was already recorded and hasn't been edited since.
+void calc_history_append(void);
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <pebble.h>
+
+#include "history.h"
+
+// Each record is packed into RECORD_BITS bits and records are laid end to end across a few persist keys, so each key
+// holds as many records as fit in PERSIST_DATA_MAX_LENGTH bytes rather than one record per key.
+#define BILL_BITS 17       // bill in cents, up to $999.99
+#define TIP_BITS 16        // tip in cents, up to MAX_TIP_PERCENT of the largest bill
+#define NUM_SPLITTING_BITS 4
+#define TIMESTAMP_BITS 27  // minutes since the epoch, good until the 2220s
+#define RECORD_BITS (BILL_BITS + TIP_BITS + NUM_SPLITTING_BITS + TIMESTAMP_BITS)
+#define BLOCK_SIZE PERSIST_DATA_MAX_LENGTH
+#define RECORDS_PER_BLOCK (BLOCK_SIZE * 8 / RECORD_BITS)
+#define NUM_BLOCKS 3
+#define MAX_RECORDS (RECORDS_PER_BLOCK * NUM_BLOCKS)
+#define PERSIST_KEY_HISTORY_HEAD 400
+#define PERSIST_KEY_HISTORY_COUNT 401
+#define PERSIST_KEY_HISTORY_BLOCK 500  // first of NUM_BLOCKS consecutive keys
+
+static bool header_loaded;
+static int head;   // slot the next record is written to
+static int count;
+
+// Only one block is kept in memory; appends and reads of neighbouring records reuse it without touching storage.
+static uint8_t block[BLOCK_SIZE];
+static int cached_block_idx = -1;
+
+
+static void bits_write(uint8_t *buffer, int bit_offset, int num_bits, uint32_t value) {
+  for(int i = 0; i < num_bits; i++) {
+    int bit = bit_offset + i;
+    if((value >> i) & 1) {
+      buffer[bit / 8] |= (uint8_t)(1 << (bit % 8));
+    } else {
+      buffer[bit / 8] &= (uint8_t)~(1 << (bit % 8));
+    }
+  }
+}
+
+
+static uint32_t bits_read(const uint8_t *buffer, int bit_offset, int num_bits) {
+  uint32_t value = 0;
+  for(int i = 0; i < num_bits; i++) {
+    int bit = bit_offset + i;
+    value |= (uint32_t)((buffer[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+  return value;
+}
+
+
+static void header_load(void) {
+  if(header_loaded) {
+    return;
+  }
+  if(persist_exists(PERSIST_KEY_HISTORY_COUNT)) {
+    head = persist_read_int(PERSIST_KEY_HISTORY_HEAD);
+    count = persist_read_int(PERSIST_KEY_HISTORY_COUNT);
+  }
+  if(head < 0 || head >= MAX_RECORDS || count < 0 || count > MAX_RECORDS) {
+    head = 0;
+    count = 0;
+  }
+  header_loaded = true;
+}
+
+
+static void block_load(int block_idx) {
+  if(block_idx == cached_block_idx) {
+    return;
+  }
+  memset(block, 0, sizeof(block));
+  if(persist_exists(PERSIST_KEY_HISTORY_BLOCK + block_idx)) {
+    persist_read_data(PERSIST_KEY_HISTORY_BLOCK + block_idx, block, sizeof(block));
+  }
+  cached_block_idx = block_idx;
+}
+
+
+void history_append(HistoryRecord record) {
+  header_load();
+
+  int bit_offset = (head % RECORDS_PER_BLOCK) * RECORD_BITS;
+  block_load(head / RECORDS_PER_BLOCK);
+
+  bits_write(block, bit_offset, BILL_BITS, (uint32_t)record.bill_in_cents);
+  bit_offset += BILL_BITS;
+  bits_write(block, bit_offset, TIP_BITS, (uint32_t)record.tip_in_cents);
+  bit_offset += TIP_BITS;
+  bits_write(block, bit_offset, NUM_SPLITTING_BITS, (uint32_t)record.num_splitting);
+  bit_offset += NUM_SPLITTING_BITS;
+  bits_write(block, bit_offset, TIMESTAMP_BITS, (uint32_t)(record.timestamp / SECONDS_PER_MINUTE));
+
+  // Only the block holding the new record is rewritten.
+  persist_write_data(PERSIST_KEY_HISTORY_BLOCK + cached_block_idx, block, sizeof(block));
+
+  head = (head + 1) % MAX_RECORDS;
+  if(count < MAX_RECORDS) {
+    count++;
+  }
+  persist_write_int(PERSIST_KEY_HISTORY_HEAD, head);
+  persist_write_int(PERSIST_KEY_HISTORY_COUNT, count);
+}
+
+
+int history_count(void) {
+  header_load();
+  return count;
+}
+
+
+bool history_get(int idx, HistoryRecord *record) {
+  header_load();
+  if(idx < 0 || idx >= count) {
+    return false;
+  }
+
+  int slot = (head - 1 - idx + MAX_RECORDS) % MAX_RECORDS;
+  int bit_offset = (slot % RECORDS_PER_BLOCK) * RECORD_BITS;
+  block_load(slot / RECORDS_PER_BLOCK);
+
+  record->bill_in_cents = (int)bits_read(block, bit_offset, BILL_BITS);
+  bit_offset += BILL_BITS;
+  record->tip_in_cents = (int)bits_read(block, bit_offset, TIP_BITS);
+  bit_offset += TIP_BITS;
+  record->num_splitting = (int)bits_read(block, bit_offset, NUM_SPLITTING_BITS);
+  bit_offset += NUM_SPLITTING_BITS;
+  record->timestamp = (time_t)bits_read(block, bit_offset, TIMESTAMP_BITS) * SECONDS_PER_MINUTE;
+  return true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <pebble.h>
+
+
+typedef struct {
+    int bill_in_cents;
+    int tip_in_cents;  // the tip actually charged, which round-total mode can make any whole number of cents
+    int num_splitting;
+    time_t timestamp;
+} HistoryRecord;
+
+//! Append a check to the history ring, overwriting the oldest one once the ring is full.
+void history_append(HistoryRecord record);
+
+//! Number of checks currently in the history ring.
+int history_count(void);
+
+//! Decode the check at idx, where 0 is the most recent. Returns false if idx is out of range.
+bool history_get(int idx, HistoryRecord *record);
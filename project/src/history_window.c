@@ -0,0 +1,68 @@
+#include <pebble.h>
+
+#include "history.h"
+#include "history_window.h"
+
+
+static Window *history_window;
+static MenuLayer *history_menu_layer;
+
+
+// ************************************************* MenuLayer callbacks **********************************************
+
+static uint16_t get_num_rows_callback(MenuLayer *menu_layer, uint16_t section_index, void *context) {
+  return (uint16_t)history_count();
+}
+
+
+static void draw_row_callback(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index, void *context) {
+  HistoryRecord record;
+  if(!history_get(cell_index->row, &record)) {
+    return;
+  }
+
+  // Rows are decoded only as they are drawn.
+  static char s_title[32];
+  snprintf(s_title, sizeof(s_title), "$%d.%02d + $%d.%02d",
+           record.bill_in_cents / 100, record.bill_in_cents % 100, record.tip_in_cents / 100, record.tip_in_cents % 100);
+
+  static char s_date[16];
+  strftime(s_date, sizeof(s_date), clock_is_24h_style() ? "%b %e %H:%M" : "%b %e %l:%M %p",
+           localtime(&record.timestamp));
+  static char s_subtitle[24];
+  snprintf(s_subtitle, sizeof(s_subtitle), "÷%d  %s", record.num_splitting, s_date);
+
+  menu_cell_basic_draw(ctx, cell_layer, s_title, s_subtitle, NULL);
+}
+
+
+// *******************************************  launch, setup, & teardown  ********************************************
+
+static void history_window_load(Window *window) {
+  Layer *window_layer = window_get_root_layer(window);
+
+  history_menu_layer = menu_layer_create(layer_get_bounds(window_layer));
+  menu_layer_set_callbacks(history_menu_layer, NULL, (MenuLayerCallbacks){
+      .get_num_rows = get_num_rows_callback,
+      .draw_row = draw_row_callback
+  });
+  menu_layer_set_click_config_onto_window(history_menu_layer, window);
+  layer_add_child(window_layer, menu_layer_get_layer(history_menu_layer));
+}
+
+
+static void history_window_unload(Window *window) {
+  menu_layer_destroy(history_menu_layer);
+  window_destroy(history_window);
+  history_window = NULL;
+}
+
+
+void history_window_push(void) {
+  history_window = window_create();
+  window_set_window_handlers(history_window, (WindowHandlers){
+      .load = history_window_load,
+      .unload = history_window_unload
+  });
+  window_stack_push(history_window, true);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <pebble.h>
+
+
+//! Push a scrollable list of recent checks, most recent first.
+void history_window_push(void);
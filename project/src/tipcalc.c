@@ -2,6 +2,7 @@
 
 #include "calculator.h"
 #include "tipcalc.h"
+#include "history_window.h"
 
 #define BOARDER 3
 #define WINDOW_INSET 5
@@ -41,6 +42,7 @@ static GFont helvetica_26;
 
 static GEdgeInsets helvetica_22_insets = {6 - BOARDER - 1, 1 - BOARDER, 0 - BOARDER - 1, 1 - BOARDER};  // t, r, b, l
 static GEdgeInsets helvetica_24_insets = {7 - BOARDER - 1, 1 - BOARDER, 0 - BOARDER - 1, 1 - BOARDER};
+static GEdgeInsets helvetica_26_insets = {8 - BOARDER - 1, 1 - BOARDER, 0 - BOARDER - 1, 1 - BOARDER};
 
 
 static GPoint field_get_left_center_point(Field *field, int16_t left_padding) {
@@ -93,6 +95,12 @@ static void input_field_update_proc(Layer *layer, GContext *ctx) {
 static void output_field_layer_update_proc(Layer *layer, GContext *ctx) {
   OutputField *output_field = (OutputField *)layer_get_data(layer);
 
+  if(output_field->is_marked && output_field->is_marked()) {
+    GRect text_frame = field_get_text_frame((Field *)output_field);
+    GRect marker_frame = grect_inset(text_frame, output_field->marker_insets);
+    graphics_draw_round_rect(ctx, marker_frame, 4);
+  }
+
   graphics_context_set_text_color(ctx, GColorBlack);
   field_draw_text((Field *)output_field, output_field->get_text(), ctx);
 }
@@ -223,6 +231,10 @@ static void select_click_handler(ClickRecognizerRef recognizer, void *context) {
     input_fields[current_input_idx]->is_selected = true;
     calc_update_totals();
     layer_mark_dirty(main_layer);
+  } else {
+    // Selecting past the last input finishes the check.
+    calc_history_append();
+    history_window_push();
   }
 }
 
@@ -240,8 +252,15 @@ static void back_click_handler(ClickRecognizerRef recognizer, void *context) {
 }
 
 
+static void select_long_click_handler(ClickRecognizerRef recognizer, void *context) {
+  calc_toggle_round_total();
+  layer_mark_dirty(main_layer);
+}
+
+
 static void click_config_provider(void *context) {
   window_single_click_subscribe(BUTTON_ID_SELECT, select_click_handler);
+  window_long_click_subscribe(BUTTON_ID_SELECT, 0, select_long_click_handler, NULL);
   window_single_click_subscribe(BUTTON_ID_BACK, back_click_handler);
   window_single_repeating_click_subscribe(BUTTON_ID_UP, BUTTON_HOLD_REPEAT_MS, up_click_handler);
   window_single_repeating_click_subscribe(BUTTON_ID_DOWN, BUTTON_HOLD_REPEAT_MS, down_click_handler);
@@ -317,7 +336,9 @@ static void main_window_load(Window* window) {
       .font = helvetica_26,
       .font_size = 26,
       .text_alignment = GTextAlignmentRight,
-      .get_text = calc_get_tip_txt
+      .get_text = calc_get_tip_txt,
+      .marker_insets = helvetica_26_insets,
+      .is_marked = calc_is_round_total_on  // round-total mode indicator
   });
 
   // Tip percent (%)
@@ -358,7 +379,9 @@ static void main_window_load(Window* window) {
       .font = helvetica_26,
       .font_size = 26,
       .text_alignment = GTextAlignmentRight,
-      .get_text = calc_get_total_per_person_txt
+      .get_text = calc_get_total_per_person_txt,
+      .marker_insets = helvetica_26_insets,
+      .is_marked = calc_is_round_total_applied  // only when a round total was reachable
   });
 
   // Number of people splitting
@@ -28,6 +28,8 @@ typedef struct {
     int16_t font_size;
     GTextAlignment text_alignment;
     GetTxtCallback *get_text;
+    GEdgeInsets marker_insets;
+    IsMarkedCallback *is_marked;  // optional; outline the field while it returns true
 } OutputField;
 
 typedef struct {
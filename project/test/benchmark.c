@@ -0,0 +1,120 @@
+#include <stdlib.h>
+
+#include <pebble.h>
+
+#include "pebble_stub.h"
+
+// Replays a standard session through the app's click handlers and update procs on the host, then prints per-frame
+// draw cost and heap use as JSON on stdout. Linked with the app's own main(), which calls app_event_loop() below.
+
+#define HOLD_CLICKS 120  // 12 seconds at the app's 100 ms repeat interval, long enough to reach the fastest increment
+#define NUM_FINISHED_CHECKS 6
+
+typedef struct {
+    double total;
+    double max;
+} Metric;
+
+static int num_frames;
+static Metric draw_calls;
+static Metric pixels;
+static Metric framebuffer_bytes;
+static Metric frame_time_us;
+
+
+static void metric_add(Metric *metric, double value) {
+  metric->total += value;
+  if(value > metric->max) {
+    metric->max = value;
+  }
+}
+
+
+static void render(void) {
+  StubFrameStats stats;
+  if(stub_render(&stats)) {
+    num_frames++;
+    metric_add(&draw_calls, stats.draw_calls);
+    metric_add(&pixels, (double)stats.pixels);
+    metric_add(&framebuffer_bytes, (double)stats.framebuffer_bytes);
+    metric_add(&frame_time_us, (double)stats.time_ns / 1000.0);
+  }
+}
+
+
+static void click(ButtonId button_id) {
+  stub_click(button_id);
+  render();
+}
+
+
+static void hold(ButtonId button_id, int num_clicks) {
+  for(int i = 1; i <= num_clicks; i++) {
+    stub_repeat_click(button_id, i);
+    render();
+  }
+}
+
+
+static void long_click(ButtonId button_id) {
+  stub_long_click(button_id);
+  render();
+}
+
+
+static void print_metric(const char *name, Metric metric) {
+  printf("  \"%s\": {\"mean\": %.2f, \"max\": %.2f},\n", name, num_frames ? metric.total / num_frames : 0.0,
+         metric.max);
+}
+
+
+// Runs after the app's deinit so anything it failed to free shows up as leaked.
+static void print_report(void) {
+  StubHeapStats heap = stub_heap_stats();
+  printf("{\n");
+  printf("  \"frames\": %d,\n", num_frames);
+  print_metric("draw_calls_per_frame", draw_calls);
+  print_metric("pixels_per_frame", pixels);
+  print_metric("framebuffer_bytes_per_frame", framebuffer_bytes);
+  print_metric("frame_time_us", frame_time_us);
+  printf("  \"allocations\": %d,\n", heap.allocations);
+  printf("  \"peak_heap_bytes\": %ld,\n", heap.peak_bytes);
+  printf("  \"leaked_heap_bytes\": %ld\n", heap.bytes_in_use);
+  printf("}\n");
+}
+
+
+void app_event_loop(void) {
+  atexit(print_report);
+  render();  // first frame after launch
+
+  // Enter a bill, holding the buttons long enough to go through every acceleration step.
+  hold(BUTTON_ID_UP, HOLD_CLICKS);
+  click(BUTTON_ID_SELECT);
+  hold(BUTTON_ID_UP, 25);
+
+  // Adjust the tip, with round-total mode toggled on, off and on again.
+  click(BUTTON_ID_SELECT);
+  hold(BUTTON_ID_DOWN, 3);
+  long_click(BUTTON_ID_SELECT);
+  hold(BUTTON_ID_UP, 5);
+  long_click(BUTTON_ID_SELECT);
+  long_click(BUTTON_ID_SELECT);
+
+  // Split the check, finish it a few times with different splits, and scroll through the history each time.
+  click(BUTTON_ID_SELECT);
+  for(int i = 0; i < NUM_FINISHED_CHECKS; i++) {
+    click(BUTTON_ID_UP);
+    click(BUTTON_ID_SELECT);
+    hold(BUTTON_ID_DOWN, NUM_FINISHED_CHECKS);
+    hold(BUTTON_ID_UP, NUM_FINISHED_CHECKS);
+    click(BUTTON_ID_BACK);
+  }
+
+  // Shake to reset, then back out of every field, which exits the app.
+  stub_accel_tap();
+  render();
+  while(!stub_window_stack_is_empty()) {
+    click(BUTTON_ID_BACK);
+  }
+}
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""Benchmark report and regression gate shared by the host build (test/CMakeLists.txt) and the watch build (wscript).
+
+A report holds, for one platform, the metrics printed by the host session replay (benchmark.c) and, from the watch
+build, the .text/.data/.bss size of the app and of each module. Session metrics are compared against the "host"
+baseline and sizes against the "arm" one. Host object sizes are not gated: they depend on the host compiler and build
+type rather than on what ships to the watch.
+"""
+
+import argparse
+import json
+import math
+import os.path
+import subprocess
+import sys
+
+BASELINE = 'benchmark_baseline.json'
+
+# Preprocessor defines for each platform's configuration of the stand-in Pebble SDK (test/stub).
+PLATFORM_DEFINES = {
+    'aplite': ['PBL_PLATFORM_APLITE', 'PBL_BW'],
+    'basalt': ['PBL_PLATFORM_BASALT', 'PBL_COLOR'],
+}
+
+SIZE_SECTIONS = ('text', 'data', 'bss')
+SIZE_TOOLCHAIN = 'arm'
+SIZE_REGRESSION_PERCENT = 5
+SIZE_REGRESSION_SLACK = 64  # bytes, so small modules aren't held to a few bytes
+
+# Draw cost and heap use are deterministic, so they get the same relative threshold with no slack, and leaks get none.
+SESSION_REGRESSION_PERCENT = 5
+EXACT_SESSION_METRICS = ('leaked_heap_bytes',)
+
+# Host frame time depends on the machine running the replay, so it is reported but neither recorded in the baseline
+# nor gated; draw calls, pixels and framebuffer bytes per frame stand in for draw cost.
+UNGATED_SESSION_METRICS = ('frame_time_us',)
+
+
+def read_sizes(size_tool, paths):
+    """Run a Berkeley-format size utility and return {path: {'text', 'data', 'bss'}}."""
+    output = subprocess.check_output([size_tool] + list(paths)).decode('utf-8')
+    sizes = {}
+    for line in output.splitlines()[1:]:
+        text, data, bss, _, _, path = line.split(None, 5)
+        sizes[path] = {'text': int(text), 'data': int(data), 'bss': int(bss)}
+    return sizes
+
+
+def run_benchmark(benchmark):
+    """Run the session replay and return its metrics."""
+    return json.loads(subprocess.check_output([benchmark]).decode('utf-8'))
+
+
+def make_report(platform, toolchain, session, app_size=None, module_sizes=None):
+    """Assemble a report; sizes are only given for the watch build."""
+    report = {'platform': platform, 'toolchain': toolchain, 'session': session}
+    if module_sizes is not None:
+        report['app'] = app_size
+        report['modules'] = module_sizes
+    return report
+
+
+def _gated_session(session):
+    return dict((name, value) for name, value in session.items() if name not in UNGATED_SESSION_METRICS)
+
+
+def load_baseline(path):
+    if not os.path.exists(path):
+        return {}
+    with open(path) as f:
+        return json.load(f)
+
+
+def update_baseline(path, report):
+    """Record the report's session metrics (host) or sizes (watch build) as the new baseline."""
+    baseline = load_baseline(path)
+    if report['toolchain'] == SIZE_TOOLCHAIN:
+        entry = {'app': report['app'], 'modules': report['modules']}
+    else:
+        entry = {'session': _gated_session(report['session'])}
+    baseline.setdefault(report['toolchain'], {})[report['platform']] = entry
+    with open(path, 'w') as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+
+def _size_limit(base):
+    return base + max(base * SIZE_REGRESSION_PERCENT // 100, SIZE_REGRESSION_SLACK)
+
+
+def _session_limit(name, base):
+    if name in EXACT_SESSION_METRICS:
+        return base
+    return base + math.ceil(base * SESSION_REGRESSION_PERCENT / 100.0)
+
+
+def _flatten(session):
+    """{'pixels_per_frame': {'mean': 1, 'max': 2}} -> {'pixels_per_frame.mean': 1, 'pixels_per_frame.max': 2}"""
+    flat = {}
+    for name, value in session.items():
+        if isinstance(value, dict):
+            for stat, stat_value in value.items():
+                flat['{}.{}'.format(name, stat)] = stat_value
+        else:
+            flat[name] = value
+    return flat
+
+
+def check(report, baseline):
+    """Compare a report against a loaded baseline. Returns a list of regression messages."""
+    platform = report['platform']
+    regressions = []
+
+    if 'modules' in report:
+        sizes = baseline.get(SIZE_TOOLCHAIN, {}).get(platform)
+        if sizes is None:
+            regressions.append('no {} size baseline for {}; record one with --update-baseline'.format(
+                SIZE_TOOLCHAIN, platform))
+        else:
+            measured = dict(report['modules'], **{'(app)': report['app']})
+            expected = dict(sizes['modules'], **{'(app)': sizes['app']})
+            for module, size in sorted(measured.items()):
+                base = expected.get(module)
+                if base is None:
+                    regressions.append('{} {}: new module has no baseline; record one with --update-baseline'.format(
+                        platform, module))
+                    continue
+                for section in SIZE_SECTIONS:
+                    if size[section] > _size_limit(base[section]):
+                        regressions.append('{} {} .{}: {} bytes (baseline {})'.format(
+                            platform, module, section, size[section], base[section]))
+
+    session = baseline.get('host', {}).get(platform, {}).get('session')
+    if session is None:
+        regressions.append('no host session baseline for {}'.format(platform))
+    else:
+        measured = _flatten(report['session'])
+        for name, base in sorted(_flatten(session).items()):
+            value = measured.get(name)
+            if value is None:
+                regressions.append('{} {}: missing from the report'.format(platform, name))
+            elif value > _session_limit(name, base):
+                regressions.append('{} {}: {} (baseline {})'.format(platform, name, value, base))
+
+    return regressions
+
+
+def gate(report, report_path, baseline_path, update):
+    """Write the report, then either record it as the baseline or check it. Returns a process exit status."""
+    with open(report_path, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+    if update:
+        update_baseline(baseline_path, report)
+        print('Recorded {} {} baseline in {}'.format(report['toolchain'], report['platform'], baseline_path))
+        return 0
+
+    regressions = check(report, load_baseline(baseline_path))
+    for regression in regressions:
+        print('Regression: ' + regression)
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--platform', required=True, choices=sorted(PLATFORM_DEFINES))
+    parser.add_argument('--benchmark', required=True, help='session replay executable')
+    parser.add_argument('--baseline', required=True)
+    parser.add_argument('--report', required=True)
+    parser.add_argument('--update-baseline', action='store_true')
+    args = parser.parse_args()
+
+    report = make_report(args.platform, 'host', run_benchmark(args.benchmark))
+    print(json.dumps(report['session'], sort_keys=True))
+    return gate(report, args.report, args.baseline, args.update_baseline)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,221 @@
+#pragma once
+
+// Host stand-in for the parts of the Pebble SDK the app uses, so calculator and UI code can be built and exercised
+// off-watch. Only behaviour the tests and benchmark rely on is modelled.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PERSIST_DATA_MAX_LENGTH 256
+#define SECONDS_PER_MINUTE 60
+
+// aplite and basalt share a 144x168 display; they differ in color depth. Build with PBL_COLOR or PBL_BW.
+#define PBL_DISPLAY_WIDTH 144
+#define PBL_DISPLAY_HEIGHT 168
+
+#if defined(PBL_COLOR)
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#else
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+#endif
+
+// ***************************************************** geometry *****************************************************
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+} GPoint;
+#define GPoint(x, y) ((GPoint){(x), (y)})
+
+typedef struct {
+    int16_t w;
+    int16_t h;
+} GSize;
+
+typedef struct {
+    GPoint origin;
+    GSize size;
+} GRect;
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+
+typedef struct {
+    int16_t top;
+    int16_t right;
+    int16_t bottom;
+    int16_t left;
+} GEdgeInsets;
+
+GRect grect_inset(GRect rect, GEdgeInsets insets);
+
+// ***************************************************** graphics *****************************************************
+
+typedef union {
+    uint8_t argb;
+} GColor8;
+typedef GColor8 GColor;
+
+#define GColorFromHEX(v) ((GColor8){.argb = (uint8_t)(0xC0 | ((((v) >> 22) & 3) << 4) | ((((v) >> 14) & 3) << 2) | \
+                                                     (((v) >> 6) & 3))})
+#define GColorBlack ((GColor8){.argb = 0xC0})
+#define GColorWhite ((GColor8){.argb = 0xFF})
+
+typedef enum {
+    GCornerNone = 0,
+    GCornersAll = 15
+} GCornerMask;
+
+typedef enum {
+    GTextAlignmentLeft,
+    GTextAlignmentCenter,
+    GTextAlignmentRight
+} GTextAlignment;
+
+typedef enum {
+    GTextOverflowModeWordWrap,
+    GTextOverflowModeTrailingEllipsis,
+    GTextOverflowModeFill
+} GTextOverflowMode;
+
+typedef struct GContext GContext;
+typedef struct GTextAttributes GTextAttributes;
+typedef struct GBitmap GBitmap;
+typedef struct StubFont *GFont;
+typedef const void *ResHandle;
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_text(GContext *ctx, const char *text, GFont const font, const GRect box,
+                        const GTextOverflowMode overflow_mode, const GTextAlignment alignment,
+                        GTextAttributes *text_attributes);
+
+// **************************************************** resources *****************************************************
+
+enum {
+    RESOURCE_ID_IMAGE_MENU_ICON = 1,
+    RESOURCE_ID_HELVETICA_ROUNDED_18,
+    RESOURCE_ID_HELVETICA_ROUNDED_22,
+    RESOURCE_ID_HELVETICA_ROUNDED_24,
+    RESOURCE_ID_HELVETICA_ROUNDED_26
+};
+
+ResHandle resource_get_handle(uint32_t resource_id);
+GFont fonts_load_custom_font(ResHandle handle);
+void fonts_unload_custom_font(GFont font);
+
+// ***************************************************** layers *******************************************************
+
+typedef struct Layer Layer;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+Layer *layer_create(GRect frame);
+Layer *layer_create_with_data(GRect frame, size_t data_size);
+void layer_destroy(Layer *layer);
+void *layer_get_data(const Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+
+// ************************************************* windows & clicks *************************************************
+
+typedef enum {
+    BUTTON_ID_BACK,
+    BUTTON_ID_UP,
+    BUTTON_ID_SELECT,
+    BUTTON_ID_DOWN,
+    NUM_BUTTONS
+} ButtonId;
+
+typedef void *ClickRecognizerRef;
+typedef void (*ClickHandler)(ClickRecognizerRef recognizer, void *context);
+typedef void (*ClickConfigProvider)(void *context);
+
+typedef struct Window Window;
+typedef void (*WindowHandler)(Window *window);
+
+typedef struct {
+    WindowHandler load;
+    WindowHandler appear;
+    WindowHandler disappear;
+    WindowHandler unload;
+} WindowHandlers;
+
+Window *window_create(void);
+void window_destroy(Window *window);
+Layer *window_get_root_layer(const Window *window);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider);
+void window_set_click_config_provider_with_context(Window *window, ClickConfigProvider click_config_provider,
+                                                  void *context);
+void window_stack_push(Window *window, bool animated);
+Window *window_stack_pop(bool animated);
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler);
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler);
+void window_long_click_subscribe(ButtonId button_id, uint16_t delay_ms, ClickHandler down_handler,
+                                 ClickHandler up_handler);
+bool click_recognizer_is_repeating(ClickRecognizerRef recognizer);
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer);
+
+// ****************************************************** menus *******************************************************
+
+typedef struct MenuLayer MenuLayer;
+
+typedef struct {
+    uint16_t section;
+    uint16_t row;
+} MenuIndex;
+
+typedef uint16_t (*MenuLayerGetNumberOfRowsInSectionsCallback)(MenuLayer *menu_layer, uint16_t section_index,
+                                                               void *callback_context);
+typedef void (*MenuLayerDrawRowCallback)(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index,
+                                         void *callback_context);
+
+typedef struct {
+    MenuLayerGetNumberOfRowsInSectionsCallback get_num_rows;
+    MenuLayerDrawRowCallback draw_row;
+} MenuLayerCallbacks;
+
+MenuLayer *menu_layer_create(GRect frame);
+void menu_layer_destroy(MenuLayer *menu_layer);
+Layer *menu_layer_get_layer(const MenuLayer *menu_layer);
+void menu_layer_set_callbacks(MenuLayer *menu_layer, void *callback_context, MenuLayerCallbacks callbacks);
+void menu_layer_set_click_config_onto_window(MenuLayer *menu_layer, Window *window);
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle,
+                          GBitmap *icon);
+
+// *************************************************** app services ***************************************************
+
+typedef enum {
+    ACCEL_AXIS_X,
+    ACCEL_AXIS_Y,
+    ACCEL_AXIS_Z
+} AccelAxisType;
+
+typedef void (*AccelTapHandler)(AccelAxisType axis, int32_t direction);
+
+void accel_tap_service_subscribe(AccelTapHandler handler);
+void accel_tap_service_unsubscribe(void);
+bool clock_is_24h_style(void);
+
+//! Runs the app until its last window is popped. Not provided by the stub library; each host program that links the
+//! app's main() supplies its own (see benchmark.c).
+void app_event_loop(void);
+
+// ************************************************ persistent storage ************************************************
+
+bool persist_exists(const uint32_t key);
+int persist_delete(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+int persist_write_int(const uint32_t key, const int32_t value);
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size);
+int persist_write_data(const uint32_t key, const void *data, const size_t size);
@@ -0,0 +1,716 @@
+#include <stdlib.h>
+
+#include "pebble_stub.h"
+
+#define MAX_PERSIST_KEYS 64
+#define MAX_WINDOW_STACK_DEPTH 8
+#define MENU_CELL_HEIGHT 44
+#define MENU_TITLE_FONT_SIZE 24
+#define MENU_SUBTITLE_FONT_SIZE 18
+#define FRAMEBUFFER_BITS_PER_PIXEL PBL_IF_COLOR_ELSE(8, 1)
+
+typedef struct {
+    uint32_t key;
+    size_t size;
+    uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} PersistEntry;
+
+struct Layer {
+    GRect frame;
+    LayerUpdateProc update_proc;
+    Layer *parent;
+    Layer *first_child;
+    Layer *next_sibling;
+    uint8_t data[];
+};
+
+typedef struct {
+    ClickHandler single;
+    ClickHandler repeating;
+    ClickHandler long_down;
+    void *context;
+} ClickSubscription;
+
+struct Window {
+    Layer *root_layer;
+    WindowHandlers handlers;
+    ClickConfigProvider click_config_provider;
+    void *click_config_context;
+    ClickSubscription clicks[NUM_BUTTONS];
+    bool is_loaded;
+};
+
+struct MenuLayer {
+    Layer *layer;
+    MenuLayerCallbacks callbacks;
+    void *callback_context;
+    int selected_row;
+};
+
+struct StubFont {
+    int size;
+};
+
+struct GContext {
+    GColor fill_color;
+    GColor stroke_color;
+    GColor text_color;
+    uint8_t stroke_width;
+    StubFrameStats *stats;
+};
+
+typedef struct {
+    bool is_repeating;
+    uint8_t num_clicks;
+} ClickRecognizer;
+
+// Every allocation is prefixed with its size so frees can be accounted for.
+typedef struct {
+    size_t size;
+} AllocationHeader;
+
+static StubHeapStats heap_stats;
+
+static Window *window_stack[MAX_WINDOW_STACK_DEPTH];
+static int window_stack_depth;
+static Window *configuring_window;  // window whose click config provider is running
+static void *configuring_context;
+static bool is_dirty;
+
+static AccelTapHandler accel_tap_handler;
+
+static PersistEntry persist_entries[MAX_PERSIST_KEYS];
+static int num_persist_entries;
+static int persist_writes;
+
+
+// ************************************************ persistent storage ************************************************
+
+static PersistEntry *persist_find(uint32_t key, bool create) {
+  for(int i = 0; i < num_persist_entries; i++) {
+    if(persist_entries[i].key == key) {
+      return &persist_entries[i];
+    }
+  }
+  if(!create) {
+    return NULL;
+  }
+  if(num_persist_entries == MAX_PERSIST_KEYS) {
+    fprintf(stderr, "pebble_stub: out of persist keys\n");
+    abort();
+  }
+  PersistEntry *entry = &persist_entries[num_persist_entries++];
+  entry->key = key;
+  entry->size = 0;
+  return entry;
+}
+
+
+void stub_persist_reset(void) {
+  num_persist_entries = 0;
+  persist_writes = 0;
+}
+
+
+int stub_persist_write_count(void) {
+  return persist_writes;
+}
+
+
+bool persist_exists(const uint32_t key) {
+  return persist_find(key, false) != NULL;
+}
+
+
+int persist_delete(const uint32_t key) {
+  PersistEntry *entry = persist_find(key, false);
+  if(entry) {
+    *entry = persist_entries[--num_persist_entries];
+  }
+  return 0;
+}
+
+
+int32_t persist_read_int(const uint32_t key) {
+  int32_t value = 0;
+  PersistEntry *entry = persist_find(key, false);
+  if(entry) {
+    memcpy(&value, entry->data, sizeof(value));
+  }
+  return value;
+}
+
+
+int persist_write_int(const uint32_t key, const int32_t value) {
+  return persist_write_data(key, &value, sizeof(value));
+}
+
+
+int persist_read_data(const uint32_t key, void *buffer, const size_t buffer_size) {
+  PersistEntry *entry = persist_find(key, false);
+  if(!entry) {
+    return -1;
+  }
+  size_t size = entry->size < buffer_size ? entry->size : buffer_size;
+  memcpy(buffer, entry->data, size);
+  return (int)size;
+}
+
+
+int persist_write_data(const uint32_t key, const void *data, const size_t size) {
+  if(size > PERSIST_DATA_MAX_LENGTH) {
+    fprintf(stderr, "pebble_stub: %zu bytes exceeds PERSIST_DATA_MAX_LENGTH\n", size);
+    abort();
+  }
+  PersistEntry *entry = persist_find(key, true);
+  memcpy(entry->data, data, size);
+  entry->size = size;
+  persist_writes++;
+  return (int)size;
+}
+
+
+// ******************************************************* heap *******************************************************
+
+static void *stub_malloc(size_t size) {
+  AllocationHeader *header = calloc(1, sizeof(AllocationHeader) + size);
+  if(!header) {
+    abort();
+  }
+  header->size = size;
+  heap_stats.allocations++;
+  heap_stats.bytes_in_use += (long)size;
+  if(heap_stats.bytes_in_use > heap_stats.peak_bytes) {
+    heap_stats.peak_bytes = heap_stats.bytes_in_use;
+  }
+  return header + 1;
+}
+
+
+static void stub_free(void *ptr) {
+  if(!ptr) {
+    return;
+  }
+  AllocationHeader *header = (AllocationHeader *)ptr - 1;
+  heap_stats.bytes_in_use -= (long)header->size;
+  free(header);
+}
+
+
+StubHeapStats stub_heap_stats(void) {
+  return heap_stats;
+}
+
+
+// ***************************************************** graphics *****************************************************
+
+GRect grect_inset(GRect rect, GEdgeInsets insets) {
+  return GRect(rect.origin.x + insets.left, rect.origin.y + insets.top,
+               rect.size.w - insets.left - insets.right, rect.size.h - insets.top - insets.bottom);
+}
+
+
+// Count a draw call touching the part of rect that lands on the display, or `outline` pixels of it if non-zero.
+static void count_draw(GContext *ctx, GRect rect, long outline) {
+  int x0 = rect.origin.x < 0 ? 0 : rect.origin.x;
+  int y0 = rect.origin.y < 0 ? 0 : rect.origin.y;
+  int x1 = rect.origin.x + rect.size.w > PBL_DISPLAY_WIDTH ? PBL_DISPLAY_WIDTH : rect.origin.x + rect.size.w;
+  int y1 = rect.origin.y + rect.size.h > PBL_DISPLAY_HEIGHT ? PBL_DISPLAY_HEIGHT : rect.origin.y + rect.size.h;
+  long area = x1 > x0 && y1 > y0 ? (long)(x1 - x0) * (y1 - y0) : 0;
+  long pixels = outline && outline < area ? outline : area;
+
+  ctx->stats->draw_calls++;
+  ctx->stats->pixels += pixels;
+  ctx->stats->framebuffer_bytes += (pixels * FRAMEBUFFER_BITS_PER_PIXEL + 7) / 8;
+}
+
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+
+void graphics_context_set_stroke_width(GContext *ctx, uint8_t stroke_width) {
+  ctx->stroke_width = stroke_width;
+}
+
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+  count_draw(ctx, rect, 0);
+}
+
+
+void graphics_draw_round_rect(GContext *ctx, GRect rect, uint16_t radius) {
+  count_draw(ctx, rect, 2L * (rect.size.w + rect.size.h));
+}
+
+
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+  int dx = abs(p1.x - p0.x);
+  int dy = abs(p1.y - p0.y);
+  int width = ctx->stroke_width ? ctx->stroke_width : 1;
+  GRect bounding_box = GRect(p0.x < p1.x ? p0.x : p1.x, (p0.y < p1.y ? p0.y : p1.y) - width / 2,
+                             dx + 1, dy + width);
+  count_draw(ctx, bounding_box, (long)((dx > dy ? dx : dy) + 1) * width);
+}
+
+
+// Glyphs are assumed to be about half as wide as the font is tall.
+static void count_text(GContext *ctx, const char *text, int font_size, GRect box) {
+  int text_width = (int)strlen(text) * font_size / 2;
+  if(text_width > box.size.w) {
+    text_width = box.size.w;
+  }
+  count_draw(ctx, GRect(box.origin.x, box.origin.y, text_width, font_size < box.size.h ? font_size : box.size.h), 0);
+}
+
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont const font, const GRect box,
+                        const GTextOverflowMode overflow_mode, const GTextAlignment alignment,
+                        GTextAttributes *text_attributes) {
+  count_text(ctx, text, font->size, box);
+}
+
+
+// **************************************************** resources *****************************************************
+
+ResHandle resource_get_handle(uint32_t resource_id) {
+  return (ResHandle)(uintptr_t)resource_id;
+}
+
+
+GFont fonts_load_custom_font(ResHandle handle) {
+  GFont font = stub_malloc(sizeof(struct StubFont));
+  switch((uintptr_t)handle) {
+    case RESOURCE_ID_HELVETICA_ROUNDED_18: font->size = 18; break;
+    case RESOURCE_ID_HELVETICA_ROUNDED_22: font->size = 22; break;
+    case RESOURCE_ID_HELVETICA_ROUNDED_24: font->size = 24; break;
+    default: font->size = 26; break;
+  }
+  return font;
+}
+
+
+void fonts_unload_custom_font(GFont font) {
+  stub_free(font);
+}
+
+
+// ***************************************************** layers *******************************************************
+
+Layer *layer_create(GRect frame) {
+  return layer_create_with_data(frame, 0);
+}
+
+
+Layer *layer_create_with_data(GRect frame, size_t data_size) {
+  Layer *layer = stub_malloc(sizeof(Layer) + data_size);
+  layer->frame = frame;
+  return layer;
+}
+
+
+static void layer_remove_from_parent(Layer *layer) {
+  if(!layer->parent) {
+    return;
+  }
+  Layer **link = &layer->parent->first_child;
+  while(*link != layer) {
+    link = &(*link)->next_sibling;
+  }
+  *link = layer->next_sibling;
+  layer->parent = NULL;
+  layer->next_sibling = NULL;
+}
+
+
+void layer_destroy(Layer *layer) {
+  if(!layer) {
+    return;
+  }
+  layer_remove_from_parent(layer);
+  for(Layer *child = layer->first_child; child; child = child->next_sibling) {
+    child->parent = NULL;
+  }
+  stub_free(layer);
+}
+
+
+void *layer_get_data(const Layer *layer) {
+  return (void *)layer->data;
+}
+
+
+GRect layer_get_bounds(const Layer *layer) {
+  return GRect(0, 0, layer->frame.size.w, layer->frame.size.h);
+}
+
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+
+void layer_add_child(Layer *parent, Layer *child) {
+  layer_remove_from_parent(child);
+  Layer **link = &parent->first_child;
+  while(*link) {
+    link = &(*link)->next_sibling;
+  }
+  *link = child;
+  child->parent = parent;
+}
+
+
+void layer_mark_dirty(Layer *layer) {
+  is_dirty = true;
+}
+
+
+static void layer_render(Layer *layer, GContext *ctx) {
+  if(layer->update_proc) {
+    layer->update_proc(layer, ctx);
+  }
+  for(Layer *child = layer->first_child; child; child = child->next_sibling) {
+    layer_render(child, ctx);
+  }
+}
+
+
+// ************************************************* windows & clicks *************************************************
+
+Window *window_create(void) {
+  Window *window = stub_malloc(sizeof(Window));
+  window->root_layer = layer_create(GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+  return window;
+}
+
+
+static int window_stack_find(Window *window) {
+  for(int i = 0; i < window_stack_depth; i++) {
+    if(window_stack[i] == window) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+static void window_unload(Window *window) {
+  if(window->is_loaded) {
+    window->is_loaded = false;
+    if(window->handlers.unload) {
+      window->handlers.unload(window);
+    }
+  }
+}
+
+
+static void window_configure_clicks(Window *window) {
+  memset(window->clicks, 0, sizeof(window->clicks));
+  if(window->click_config_provider) {
+    configuring_window = window;
+    configuring_context = window->click_config_context;
+    window->click_config_provider(window->click_config_context);
+    configuring_window = NULL;
+  }
+  is_dirty = true;
+}
+
+
+static Window *window_stack_top(void) {
+  return window_stack_depth ? window_stack[window_stack_depth - 1] : NULL;
+}
+
+
+static void window_stack_remove(int idx) {
+  Window *window = window_stack[idx];
+  bool was_top = idx == window_stack_depth - 1;
+  memmove(&window_stack[idx], &window_stack[idx + 1], sizeof(Window *) * (size_t)(window_stack_depth - idx - 1));
+  window_stack_depth--;
+  window_unload(window);  // may destroy the window
+  if(was_top && window_stack_top()) {
+    window_configure_clicks(window_stack_top());
+  }
+}
+
+
+void window_destroy(Window *window) {
+  if(!window) {
+    return;
+  }
+  int idx = window_stack_find(window);
+  if(idx >= 0) {
+    window_stack_remove(idx);
+  }
+  layer_destroy(window->root_layer);
+  stub_free(window);
+}
+
+
+Layer *window_get_root_layer(const Window *window) {
+  return window->root_layer;
+}
+
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider) {
+  window_set_click_config_provider_with_context(window, click_config_provider, NULL);
+}
+
+
+void window_set_click_config_provider_with_context(Window *window, ClickConfigProvider click_config_provider,
+                                                  void *context) {
+  window->click_config_provider = click_config_provider;
+  window->click_config_context = context;
+}
+
+
+void window_stack_push(Window *window, bool animated) {
+  if(window_stack_depth == MAX_WINDOW_STACK_DEPTH) {
+    fprintf(stderr, "pebble_stub: window stack overflow\n");
+    abort();
+  }
+  window_stack[window_stack_depth++] = window;
+  if(!window->is_loaded) {
+    window->is_loaded = true;
+    if(window->handlers.load) {
+      window->handlers.load(window);
+    }
+  }
+  window_configure_clicks(window);
+}
+
+
+Window *window_stack_pop(bool animated) {
+  Window *window = window_stack_top();
+  if(window) {
+    window_stack_remove(window_stack_depth - 1);
+  }
+  return window;
+}
+
+
+bool stub_window_stack_is_empty(void) {
+  return window_stack_depth == 0;
+}
+
+
+void stub_window_stack_pop_all(void) {
+  while(window_stack_depth) {
+    window_stack_pop(false);
+  }
+}
+
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler) {
+  configuring_window->clicks[button_id].single = handler;
+  configuring_window->clicks[button_id].context = configuring_context;
+}
+
+
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler) {
+  configuring_window->clicks[button_id].repeating = handler;
+  configuring_window->clicks[button_id].context = configuring_context;
+}
+
+
+void window_long_click_subscribe(ButtonId button_id, uint16_t delay_ms, ClickHandler down_handler,
+                                 ClickHandler up_handler) {
+  configuring_window->clicks[button_id].long_down = down_handler;
+  configuring_window->clicks[button_id].context = configuring_context;
+}
+
+
+bool click_recognizer_is_repeating(ClickRecognizerRef recognizer) {
+  return ((ClickRecognizer *)recognizer)->is_repeating;
+}
+
+
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer) {
+  return ((ClickRecognizer *)recognizer)->num_clicks;
+}
+
+
+void stub_repeat_click(ButtonId button_id, int num_clicks) {
+  Window *window = window_stack_top();
+  if(!window) {
+    return;
+  }
+  ClickSubscription *click = &window->clicks[button_id];
+  ClickRecognizer recognizer = {.is_repeating = num_clicks > 1, .num_clicks = (uint8_t)num_clicks};
+  if(recognizer.is_repeating && click->repeating) {
+    click->repeating(&recognizer, click->context);
+  } else if(!recognizer.is_repeating && (click->single || click->repeating)) {
+    (click->single ? click->single : click->repeating)(&recognizer, click->context);
+  } else if(!recognizer.is_repeating && button_id == BUTTON_ID_BACK) {
+    window_stack_pop(true);  // default back behaviour
+  }
+}
+
+
+void stub_click(ButtonId button_id) {
+  stub_repeat_click(button_id, 1);
+}
+
+
+void stub_long_click(ButtonId button_id) {
+  Window *window = window_stack_top();
+  if(window && window->clicks[button_id].long_down) {
+    ClickRecognizer recognizer = {.is_repeating = false, .num_clicks = 1};
+    window->clicks[button_id].long_down(&recognizer, window->clicks[button_id].context);
+  }
+}
+
+
+bool stub_render(StubFrameStats *stats) {
+  Window *window = window_stack_top();
+  memset(stats, 0, sizeof(*stats));
+  if(!window || !is_dirty) {
+    return false;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  GContext ctx = {.fill_color = GColorWhite, .stroke_color = GColorBlack, .text_color = GColorBlack,
+                  .stroke_width = 1, .stats = stats};
+  graphics_fill_rect(&ctx, layer_get_bounds(window->root_layer), 0, GCornerNone);  // window background
+  layer_render(window->root_layer, &ctx);
+  is_dirty = false;
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  stats->time_ns = (end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec);
+  return true;
+}
+
+
+// ****************************************************** menus *******************************************************
+
+static void menu_layer_update_proc(Layer *layer, GContext *ctx) {
+  MenuLayer *menu_layer = *(MenuLayer **)layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+  int num_rows = menu_layer->callbacks.get_num_rows ?
+                 menu_layer->callbacks.get_num_rows(menu_layer, 0, menu_layer->callback_context) : 0;
+
+  // Scroll just far enough to keep the selected row on screen.
+  int num_visible_rows = bounds.size.h / MENU_CELL_HEIGHT + 1;
+  int first_row = menu_layer->selected_row >= num_visible_rows ? menu_layer->selected_row - num_visible_rows + 2 : 0;
+
+  for(int row = first_row; row < num_rows && row < first_row + num_visible_rows; row++) {
+    Layer cell_layer = {.frame = GRect(0, (row - first_row) * MENU_CELL_HEIGHT, bounds.size.w, MENU_CELL_HEIGHT)};
+    if(row == menu_layer->selected_row) {
+      graphics_fill_rect(ctx, cell_layer.frame, 0, GCornerNone);
+    }
+    MenuIndex cell_index = {.section = 0, .row = (uint16_t)row};
+    menu_layer->callbacks.draw_row(ctx, &cell_layer, &cell_index, menu_layer->callback_context);
+  }
+}
+
+
+MenuLayer *menu_layer_create(GRect frame) {
+  MenuLayer *menu_layer = stub_malloc(sizeof(MenuLayer));
+  menu_layer->layer = layer_create_with_data(frame, sizeof(MenuLayer *));
+  *(MenuLayer **)layer_get_data(menu_layer->layer) = menu_layer;
+  layer_set_update_proc(menu_layer->layer, menu_layer_update_proc);
+  return menu_layer;
+}
+
+
+void menu_layer_destroy(MenuLayer *menu_layer) {
+  layer_destroy(menu_layer->layer);
+  stub_free(menu_layer);
+}
+
+
+Layer *menu_layer_get_layer(const MenuLayer *menu_layer) {
+  return menu_layer->layer;
+}
+
+
+void menu_layer_set_callbacks(MenuLayer *menu_layer, void *callback_context, MenuLayerCallbacks callbacks) {
+  menu_layer->callback_context = callback_context;
+  menu_layer->callbacks = callbacks;
+}
+
+
+static void menu_layer_scroll(MenuLayer *menu_layer, int delta) {
+  int num_rows = menu_layer->callbacks.get_num_rows(menu_layer, 0, menu_layer->callback_context);
+  int row = menu_layer->selected_row + delta;
+  if(row >= 0 && row < num_rows) {
+    menu_layer->selected_row = row;
+    layer_mark_dirty(menu_layer->layer);
+  }
+}
+
+
+static void menu_up_click_handler(ClickRecognizerRef recognizer, void *context) {
+  menu_layer_scroll(context, -1);
+}
+
+
+static void menu_down_click_handler(ClickRecognizerRef recognizer, void *context) {
+  menu_layer_scroll(context, 1);
+}
+
+
+static void menu_click_config_provider(void *context) {
+  window_single_repeating_click_subscribe(BUTTON_ID_UP, 100, menu_up_click_handler);
+  window_single_repeating_click_subscribe(BUTTON_ID_DOWN, 100, menu_down_click_handler);
+}
+
+
+void menu_layer_set_click_config_onto_window(MenuLayer *menu_layer, Window *window) {
+  window_set_click_config_provider_with_context(window, menu_click_config_provider, menu_layer);
+}
+
+
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle,
+                          GBitmap *icon) {
+  GRect frame = cell_layer->frame;
+  count_text(ctx, title, MENU_TITLE_FONT_SIZE, GRect(frame.origin.x + 4, frame.origin.y, frame.size.w - 8,
+                                                     MENU_TITLE_FONT_SIZE + 4));
+  if(subtitle) {
+    count_text(ctx, subtitle, MENU_SUBTITLE_FONT_SIZE,
+               GRect(frame.origin.x + 4, frame.origin.y + MENU_TITLE_FONT_SIZE, frame.size.w - 8,
+                     MENU_SUBTITLE_FONT_SIZE + 2));
+  }
+}
+
+
+// *************************************************** app services ***************************************************
+
+void accel_tap_service_subscribe(AccelTapHandler handler) {
+  accel_tap_handler = handler;
+}
+
+
+void accel_tap_service_unsubscribe(void) {
+  accel_tap_handler = NULL;
+}
+
+
+void stub_accel_tap(void) {
+  if(accel_tap_handler) {
+    accel_tap_handler(ACCEL_AXIS_Z, 1);
+  }
+}
+
+
+bool clock_is_24h_style(void) {
+  return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <pebble.h>
+
+// Hooks into the host stand-in for the Pebble SDK; only tests and the benchmark use these.
+
+//! Forget everything in persistent storage and reset the write counter.
+void stub_persist_reset(void);
+
+//! Number of persist_write_* calls since the last stub_persist_reset().
+int stub_persist_write_count(void);
+
+typedef struct {
+    int draw_calls;
+    long pixels;             // pixels touched, after clipping to the display
+    long framebuffer_bytes;  // pixels at the platform's color depth (1 bit on aplite, 8 on basalt)
+    long time_ns;
+} StubFrameStats;
+
+typedef struct {
+    int allocations;
+    long bytes_in_use;
+    long peak_bytes;
+} StubHeapStats;
+
+//! Deliver a single click to the top window.
+void stub_click(ButtonId button_id);
+
+//! Deliver the num_clicks'th click of a button being held down; 1 is the initial press, later ones go to the repeating
+//! click handler.
+void stub_repeat_click(ButtonId button_id, int num_clicks);
+
+//! Deliver a long click to the top window.
+void stub_long_click(ButtonId button_id);
+
+//! Deliver a tap to the accelerometer tap subscriber, if any.
+void stub_accel_tap(void);
+
+//! Redraw the top window if anything was marked dirty since the last frame. Returns false if nothing was drawn.
+bool stub_render(StubFrameStats *stats);
+
+//! Whether the app has popped its last window.
+bool stub_window_stack_is_empty(void);
+
+//! Pop every window, as the system does when the app exits.
+void stub_window_stack_pop_all(void);
+
+//! Heap usage by the stubbed SDK objects (layers, windows, menus, fonts) since startup.
+StubHeapStats stub_heap_stats(void);
@@ -0,0 +1,130 @@
+#include <pebble.h>
+
+#include "calculator.h"
+#include "pebble_stub.h"
+
+// Built against history.c directly so the test can see its layout macros and drop its in-memory state to simulate the
+// app being relaunched. calculator.c is linked in too, and its history_append() calls land in this copy.
+#include "history.c"
+
+#define NUM_APPENDS 250  // enough to wrap the ring twice
+#define BASE_TIMESTAMP 1700000040  // on a whole minute, since timestamps are stored to the minute
+
+static int num_failed;
+
+#define CHECK(cond) do { \
+    if(!(cond)) { \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      num_failed++; \
+    } \
+  } while(0)
+
+
+static HistoryRecord make_record(int i) {
+  return (HistoryRecord){
+      .bill_in_cents = 99999 - i,
+      .tip_in_cents = (i * 997) % 40000,
+      .num_splitting = 1 + i % 9,
+      .timestamp = BASE_TIMESTAMP + i * SECONDS_PER_MINUTE
+  };
+}
+
+
+static bool records_equal(HistoryRecord a, HistoryRecord b) {
+  return a.bill_in_cents == b.bill_in_cents && a.tip_in_cents == b.tip_in_cents &&
+         a.num_splitting == b.num_splitting && a.timestamp == b.timestamp;
+}
+
+
+// The newest MAX_RECORDS of the first num_appended records should read back newest first.
+static void check_contents(int num_appended) {
+  int expected_count = num_appended < MAX_RECORDS ? num_appended : MAX_RECORDS;
+  CHECK(history_count() == expected_count);
+  for(int idx = 0; idx < expected_count; idx++) {
+    HistoryRecord record;
+    CHECK(history_get(idx, &record));
+    CHECK(records_equal(record, make_record(num_appended - 1 - idx)));
+  }
+  HistoryRecord record;
+  CHECK(!history_get(expected_count, &record));
+  CHECK(!history_get(-1, &record));
+}
+
+
+static void simulate_relaunch(void) {
+  header_loaded = false;
+  head = 0;
+  count = 0;
+  cached_block_idx = -1;
+  memset(block, 0, sizeof(block));
+}
+
+
+// Finishing a check records it once; editing it, even back to the same values, makes it a new check.
+static void check_calculator_append(void) {
+  stub_persist_reset();
+  simulate_relaunch();
+
+  calc_reset_to_defaults();
+  calc_history_append();
+  calc_history_append();
+  CHECK(history_count() == 1);
+
+  calc_manip_bill_dollars(1);
+  calc_manip_bill_dollars(-1);
+  calc_update_totals();
+  calc_history_append();
+  calc_history_append();
+  CHECK(history_count() == 2);
+
+  calc_toggle_round_total();
+  calc_history_append();
+  CHECK(history_count() == 3);
+  calc_manip_tip_percent(1);
+  calc_history_append();
+  CHECK(history_count() == 4);
+  calc_history_append();
+  CHECK(history_count() == 4);
+
+  HistoryRecord record;
+  CHECK(history_get(0, &record));
+  CHECK(record.bill_in_cents == 1000 && record.tip_in_cents == 300 && record.num_splitting == 1);
+}
+
+
+int main(void) {
+  check_calculator_append();
+  stub_persist_reset();
+  simulate_relaunch();
+
+  CHECK(RECORD_BITS == 64);
+  CHECK(RECORDS_PER_BLOCK == 32);
+  CHECK(MAX_RECORDS == 96);
+  CHECK(history_count() == 0);
+
+  // Fill part of the ring, then make sure the records survive a relaunch.
+  for(int i = 0; i < 50; i++) {
+    history_append(make_record(i));
+  }
+  check_contents(50);
+  simulate_relaunch();
+  check_contents(50);
+
+  // Keep appending past the end of the ring; the oldest records are overwritten.
+  int writes_before = stub_persist_write_count();
+  clock_t start = clock();
+  for(int i = 50; i < NUM_APPENDS; i++) {
+    history_append(make_record(i));
+  }
+  double append_us = 1e6 * (double)(clock() - start) / CLOCKS_PER_SEC / (NUM_APPENDS - 50);
+  double writes_per_append = (double)(stub_persist_write_count() - writes_before) / (NUM_APPENDS - 50);
+  CHECK(writes_per_append == 3.0);
+  check_contents(NUM_APPENDS);
+  simulate_relaunch();
+  check_contents(NUM_APPENDS);
+
+  printf("%d bits/record, %d records/key, %d records in %d keys\n",
+         RECORD_BITS, RECORDS_PER_BLOCK, MAX_RECORDS, NUM_BLOCKS);
+  printf("append: %.2f persist writes, %.2f us on host\n", writes_per_append, append_us);
+  return num_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#include <pebble.h>
+
+#include "calculator.h"
+
+// Checks calc_compute_tip_in_cents() in round-total mode against a trial-and-error reference over every bill from
+// $1.00 to $999.99, every tip percent and every split, and that up/down step through round totals one at a time.
+
+#define MIN_BILL_IN_CENTS 100
+#define MAX_BILL_IN_CENTS 99999
+#define MIN_TIP_PERCENT 1
+#define MAX_TIP_PERCENT 40
+#define MAX_NUM_SPLITTING 9
+
+
+// Walk outward from the unrounded tip one cent at a time until a tip in range gives a round total, preferring the
+// larger tip on ties. Falls back to the unrounded tip if every tip in range has been tried.
+static int reference_round_tip(int bill_in_cents, int percent, int splitting) {
+  int step = 100 * splitting;
+  int tip_in_cents = (bill_in_cents * percent + 50) / 100;
+  int min_tip = (bill_in_cents * MIN_TIP_PERCENT + 50) / 100;
+  int max_tip = (bill_in_cents * MAX_TIP_PERCENT + 50) / 100;
+
+  // Track (bill + tip) % step for the candidates above and below instead of dividing on every step.
+  int up_remainder = (bill_in_cents + tip_in_cents) % step;
+  int down_remainder = up_remainder;
+  for(int distance = 0; tip_in_cents + distance <= max_tip || tip_in_cents - distance >= min_tip; distance++) {
+    if(tip_in_cents + distance <= max_tip && up_remainder == 0) {
+      return tip_in_cents + distance;
+    }
+    if(tip_in_cents - distance >= min_tip && down_remainder == 0) {
+      return tip_in_cents - distance;
+    }
+    up_remainder = up_remainder == step - 1 ? 0 : up_remainder + 1;
+    down_remainder = down_remainder == 0 ? step - 1 : down_remainder - 1;
+  }
+  return tip_in_cents;
+}
+
+
+static int total_in_cents(void) {
+  int dollars, cents;
+  sscanf(calc_get_total_per_person_txt(), "$%d.%d", &dollars, &cents);
+  return 100 * dollars + cents;
+}
+
+
+// A $10.00 bill can reach round totals of $11 through $14 (a $0.10 to $4.00 tip). Starting from the default 15%
+// ($11.50, which snaps up to $12), each press should move exactly one round total and wrap at either end.
+static long check_stepping(void) {
+  static const int expected_up[] = {1300, 1400, 1100, 1200};
+  static const int expected_down[] = {1100, 1400, 1300, 1200};
+  long num_failed = 0;
+
+  calc_reset_to_defaults();
+  calc_toggle_round_total();
+  num_failed += total_in_cents() != 1200;
+  for(unsigned i = 0; i < sizeof(expected_up) / sizeof(expected_up[0]); i++) {
+    calc_manip_tip_percent(1);
+    if(total_in_cents() != expected_up[i] && num_failed++ < 10) {
+      printf("FAIL up press %u: total %d, expected %d\n", i + 1, total_in_cents(), expected_up[i]);
+    }
+  }
+  for(unsigned i = 0; i < sizeof(expected_down) / sizeof(expected_down[0]); i++) {
+    calc_manip_tip_percent(-1);
+    if(total_in_cents() != expected_down[i] && num_failed++ < 10) {
+      printf("FAIL down press %u: total %d, expected %d\n", i + 1, total_in_cents(), expected_down[i]);
+    }
+  }
+  return num_failed;
+}
+
+
+int main(void) {
+  long num_stepping_failed = check_stepping();
+  long num_checked = 0;
+  long num_failed = 0;
+
+  for(int bill_in_cents = MIN_BILL_IN_CENTS; bill_in_cents <= MAX_BILL_IN_CENTS; bill_in_cents++) {
+    for(int splitting = 1; splitting <= MAX_NUM_SPLITTING; splitting++) {
+      for(int percent = MIN_TIP_PERCENT; percent <= MAX_TIP_PERCENT; percent++) {
+        int expected = reference_round_tip(bill_in_cents, percent, splitting);
+        int actual = calc_compute_tip_in_cents(bill_in_cents, percent, splitting, true);
+        num_checked++;
+        if(actual != expected && num_failed++ < 10) {
+          printf("FAIL bill=%d percent=%d splitting=%d: got %d, expected %d\n",
+                 bill_in_cents, percent, splitting, actual, expected);
+        }
+      }
+    }
+  }
+
+  printf("%ld of %ld round-total queries match the reference\n", num_checked - num_failed, num_checked);
+  return num_failed == 0 && num_stepping_failed == 0 ? 0 : 1;
+}